@@ -5,6 +5,8 @@
 #include <numeric>
 #include <span>
 
+#include "Balancer.hpp"
+#include "BusTiming.hpp"
 #include "Driver.hpp"
 #include "LTC6810.hpp"
 #include "NetworkLink.hpp"
@@ -14,6 +16,12 @@ constexpr size_t N_CELLS{6};
 constexpr bool DIAG{true};
 constexpr int32_t TIME_SLEEP_US{1800000};
 constexpr int32_t TIME_REFUP_US{4400};
+constexpr int32_t TIME_CONV_MARGIN_US{20000};
+constexpr float BALANCING_THRESHOLD_V{0.010};
+constexpr float BALANCING_RELEASE_V{0.005};
+constexpr LTC6810Driver::DischargeTime BALANCING_TIME{
+    LTC6810Driver::DischargeTime::MIN_0_5};
+constexpr int32_t TIME_BALANCING_REFRESH_US{10000000};
 
 enum class CoreState {
     SLEEP,
@@ -39,14 +47,22 @@ concept BMSConfig = requires(T) {
     { std::integral<decltype(T::tick_resolution_us)> };
     { std::integral<decltype(T::period_us)> };
     { std::integral<decltype(T::conv_rate_time_ms)> };
+    { std::integral<decltype(T::SPI_clock_hz)> };
 };
 
 template <BMSConfig config>
 class BMS {
     using DriverLTC = LTC6810Driver::LTC6810<N_CELLS, config::period_us,
                                              config::conv_rate_time_ms>;
+    using Timing =
+        LTC6810Driver::BusTiming<config::n_LTC6810, config::SPI_clock_hz>;
 
-    static consteval LTC6810Driver::StateMachine<CoreState, 6, 7>
+    static_assert(
+        Timing::cycle_time_us(LTC6810Driver::AdcMode::KHZ_27) <=
+            config::period_us,
+        "period_us can not be met with this chain length and SPI clock");
+
+    static consteval LTC6810Driver::StateMachine<CoreState, 6, 9>
     make_core_sm() {
         constexpr LTC6810Driver::State sleep =
             make_state(CoreState::SLEEP, sleep_action,
@@ -60,7 +76,9 @@ class BMS {
         constexpr LTC6810Driver::State measuring_cells =
             make_state(CoreState::MEASURING_CELLS, measure_cells,
                        LTC6810Driver::Transition{CoreState::READING_CELLS,
-                                                 conversion_done_guard});
+                                                 conversion_done_guard},
+                       LTC6810Driver::Transition{CoreState::SLEEP,
+                                                 cells_timeout_guard});
         constexpr LTC6810Driver::State reading_cells =
             make_state(CoreState::READING_CELLS, read_cells,
                        LTC6810Driver::Transition{CoreState::MEASURING_GPIOS,
@@ -68,7 +86,9 @@ class BMS {
         constexpr LTC6810Driver::State measuring_gpios =
             make_state(CoreState::MEASURING_GPIOS, measure_GPIOs,
                        LTC6810Driver::Transition{CoreState::READING_GPIOS,
-                                                 conversion_done_guard});
+                                                 conversion_done_guard},
+                       LTC6810Driver::Transition{CoreState::SLEEP,
+                                                 GPIOs_timeout_guard});
         constexpr LTC6810Driver::State reading_gpios =
             make_state(CoreState::READING_GPIOS, read_GPIOs,
                        LTC6810Driver::Transition{CoreState::STANDBY,
@@ -79,7 +99,7 @@ class BMS {
                                   measuring_gpios, reading_gpios);
     }
 
-    static inline LTC6810Driver::StateMachine<CoreState, 6, 7> core_sm{
+    static inline LTC6810Driver::StateMachine<CoreState, 6, 9> core_sm{
         make_core_sm()};
 
     static inline LTC6810Driver::Driver<config::n_LTC6810> driver{
@@ -87,11 +107,18 @@ class BMS {
                                  config::SPI_CS_turn_off,
                                  config::SPI_CS_turn_on}};
 
-    static inline uint32_t init_conv{};
-    static inline uint32_t final_conv{};
+    static inline int32_t init_conv{};
+    static inline int32_t final_conv{};
+    static inline int32_t conv_deadline{};
+    static inline uint32_t conv_timeouts{};
 
     static inline array<DriverLTC, config::n_LTC6810> ltcs{};
 
+    static inline LTC6810Driver::Balancer<config::n_LTC6810, N_CELLS> balancer{
+        BALANCING_THRESHOLD_V, BALANCING_RELEASE_V};
+    static inline bool balancing{false};
+    static inline int32_t last_config_write{};
+
     static inline int32_t current_time{};
     static inline int32_t sleep_reference{};
     static inline int32_t last_read{};
@@ -99,6 +126,8 @@ class BMS {
     static inline int32_t time_to_read{};
     static inline int32_t reading_period{};
 
+    static inline LTC6810Driver::BusReport bus_report{};
+
     // Actions
     static void sleep_action() {}
     static void standby_action() {
@@ -106,6 +135,9 @@ class BMS {
     }
     static void measure_cells() {
         init_conv = config::get_tick() * config::tick_resolution_us;
+        conv_deadline = init_conv +
+                        Timing::cells_conversion_time_us(driver.get_mode()) +
+                        TIME_CONV_MARGIN_US;
         driver.start_cell_conversion();
     }
     static void read_cells() {
@@ -114,6 +146,7 @@ class BMS {
             for (uint j{}; j < N_CELLS; ++j) {
                 if (cells[i][j]) {
                     ltcs[i].cells[j] = cells[i][j].value();
+                    ltcs[i].cells_timestamp[j] = current_time;
                     if constexpr (DIAG) {
                         ltcs[i].conv_successful();
                     }
@@ -125,8 +158,32 @@ class BMS {
                 ltcs[i].total_voltage = cells[i][6].value();
             }
         }
+
+        balance(cells);
+    }
+    static void balance(
+        const array<array<std::optional<float>, 7>, config::n_LTC6810>& cells) {
+        if (balancing) {
+            driver.set_discharge(balancer.compute(cells), BALANCING_TIME);
+        } else {
+            balancer.reset();
+            driver.set_discharge({}, LTC6810Driver::DischargeTime::DISABLED);
+        }
+
+        // Rewrite before the discharge timer expires while still balancing
+        if (driver.is_config_changed() ||
+            (balancing && (current_time - last_config_write) >=
+                              TIME_BALANCING_REFRESH_US)) {
+            driver.write_config();
+            last_config_write = current_time;
+        }
+    }
+    static void measure_GPIOs() {
+        conv_deadline = config::get_tick() * config::tick_resolution_us +
+                        Timing::GPIOs_conversion_time_us(driver.get_mode()) +
+                        TIME_CONV_MARGIN_US;
+        driver.start_GPIOs_conversion();
     }
-    static void measure_GPIOs() { driver.start_GPIOs_conversion(); }
     static void read_GPIOs() {
         auto GPIOs = driver.read_GPIOs();
         for (uint i{}; i < config::n_LTC6810; ++i) {
@@ -147,6 +204,10 @@ class BMS {
         reading_period = final_conv - last_read;
         last_read = final_conv;
 
+        bus_report = Timing::report(driver.get_link_stats(), reading_period,
+                                    driver.get_mode(), config::period_us);
+        driver.reset_link_stats();
+
         if (reading_period > config::period_us) {
             driver.faster_conv();
         }
@@ -156,6 +217,7 @@ class BMS {
     static bool sleep_timeout_guard() {
         if ((current_time - last_read) >= (config::period_us - time_to_read)) {
             driver.wake_up();
+            last_config_write = current_time;
             return true;
         }
         return false;
@@ -168,6 +230,29 @@ class BMS {
         return (current_time - sleep_reference) >= TIME_SLEEP_US;
     }
     static bool conversion_done_guard() { return driver.is_conv_done(); }
+    // A conversion that never completes sends the chain back to sleep, so the
+    // next cycle wakes it up and rewrites the configuration
+    template <size_t N_CHANNELS>
+    static bool conversion_timeout_guard() {
+        if ((current_time - conv_deadline) < 0) {
+            return false;
+        }
+        ++conv_timeouts;
+        if constexpr (DIAG) {
+            for (auto& ltc : ltcs) {
+                for (uint j{}; j < N_CHANNELS; ++j) {
+                    ltc.conv_failed();
+                }
+            }
+        }
+        return true;
+    }
+    static bool cells_timeout_guard() {
+        return conversion_timeout_guard<N_CELLS>();
+    }
+    static bool GPIOs_timeout_guard() {
+        return conversion_timeout_guard<N_GPIOS>();
+    }
 
    public:
     static void update() {
@@ -178,5 +263,18 @@ class BMS {
     static array<DriverLTC, config::n_LTC6810>& get_data() { return ltcs; }
 
     static int32_t& get_period() { return reading_period; }
+
+    static uint32_t get_conv_timeouts() { return conv_timeouts; }
+
+    static const LTC6810Driver::BusReport& get_bus_report() {
+        return bus_report;
+    }
+
+    static void start_balancing() { balancing = true; }
+    static void stop_balancing() { balancing = false; }
+    static void set_balancing_thresholds(float threshold,
+                                         float release_threshold) {
+        balancer.set_thresholds(threshold, release_threshold);
+    }
 };
 #endif
\ No newline at end of file
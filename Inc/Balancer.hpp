@@ -0,0 +1,73 @@
+#ifndef BALANCER_HPP
+#define BALANCER_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+
+using std::array;
+
+namespace LTC6810Driver {
+
+template <size_t N_LTC6810, size_t N_CELLS>
+class Balancer {
+    float threshold{};
+    float release_threshold{};
+
+    array<uint8_t, N_LTC6810> discharge{};
+
+   public:
+    // release_threshold is clamped to threshold, a discharging cell never
+    // stops before it is back under the level that started it
+    constexpr Balancer(float threshold, float release_threshold)
+        : threshold(threshold),
+          release_threshold(std::min(release_threshold, threshold)) {}
+
+    void set_thresholds(float new_threshold, float new_release_threshold) {
+        threshold = new_threshold;
+        release_threshold = std::min(new_release_threshold, new_threshold);
+    }
+
+    void reset() { discharge = {}; }
+
+    // Returns one discharge mask per LTC6810, bit j set to discharge cell j.
+    // A cell starts discharging above threshold and keeps discharging until it
+    // falls below release_threshold, so cells near the threshold don't toggle.
+    // Cells that were not read correctly this cycle are never discharged.
+    template <size_t N_VALUES>
+    const array<uint8_t, N_LTC6810>& compute(
+        const array<array<std::optional<float>, N_VALUES>, N_LTC6810>& cells) {
+        static_assert(N_VALUES >= N_CELLS);
+
+        float min_cell{std::numeric_limits<float>::max()};
+        for (size_t i{0}; i < N_LTC6810; ++i) {
+            for (size_t j{0}; j < N_CELLS; ++j) {
+                if (cells[i][j] && cells[i][j].value() < min_cell) {
+                    min_cell = cells[i][j].value();
+                }
+            }
+        }
+
+        for (size_t i{0}; i < N_LTC6810; ++i) {
+            uint8_t mask{};
+            for (size_t j{0}; j < N_CELLS; ++j) {
+                if (!cells[i][j]) {
+                    continue;
+                }
+                bool discharging = discharge[i] & (1 << j);
+                float spread{cells[i][j].value() - min_cell};
+                if (spread > (discharging ? release_threshold : threshold)) {
+                    mask |= 1 << j;
+                }
+            }
+            discharge[i] = mask;
+        }
+        return discharge;
+    }
+};
+}  // namespace LTC6810Driver
+
+#endif
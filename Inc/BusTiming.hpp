@@ -0,0 +1,110 @@
+#ifndef BUS_TIMING_HPP
+#define BUS_TIMING_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Driver.hpp"
+#include "NetworkLink.hpp"
+
+namespace LTC6810Driver {
+
+struct BusReport {
+    uint32_t transactions{};
+    uint32_t bytes{};
+    int32_t bus_time_us{};
+    int32_t cycle_time_us{};
+    int32_t expected_cycle_time_us{};
+    int32_t headroom_us{};
+    float utilization{};
+    float idle{};
+};
+
+template <size_t N_LTC6810, uint32_t SPI_CLOCK_HZ>
+struct BusTiming {
+    using Link = NetworkLink<N_LTC6810>;
+
+    // ADCVSC converts the 6 cells plus the sum of cells, ADAX converts
+    // S0, GPIO1-4 and the second reference
+    static constexpr size_t cell_channels{7};
+    static constexpr size_t GPIO_channels{6};
+
+    // Worst case of a cycle: waking the chain from SLEEP writes CFG, and so
+    // do a balancing change and an ADCOPT change in faster_conv()
+    static constexpr size_t config_writes{3};
+    static constexpr size_t config_bytes{Link::wake_up_bytes +
+                                         config_writes * Link::write_bytes};
+    // One conversion (ADCVSC/ADAX) polled once, then its register reads.
+    // Further polls depend on how often BMS::update() is called.
+    static constexpr size_t cells_bytes{Link::send_bytes + Link::poll_bytes +
+                                        3 * Link::read_bytes};
+    static constexpr size_t GPIOs_bytes{Link::send_bytes + Link::poll_bytes +
+                                        2 * Link::read_bytes};
+    static constexpr size_t cycle_bytes{config_bytes + cells_bytes +
+                                        GPIOs_bytes};
+
+    static constexpr int32_t wire_time_us(size_t bytes) {
+        return static_cast<int32_t>(
+            (static_cast<uint64_t>(bytes) * 8 * 1000000 + SPI_CLOCK_HZ - 1) /
+            SPI_CLOCK_HZ);
+    }
+
+    // Conversion time of one channel, rounded up from the datasheet tables
+    static constexpr int32_t channel_time_us(AdcMode mode) {
+        switch (mode) {
+            case AdcMode::KHZ_27:
+                return 186;
+            case AdcMode::KHZ_14:
+                return 215;
+            case AdcMode::KHZ_7:
+                return 390;
+            case AdcMode::KHZ_3:
+                return 506;
+            case AdcMode::KHZ_2:
+                return 739;
+            case AdcMode::KHZ_1:
+                return 1178;
+            case AdcMode::HZ_422:
+                return 2135;
+            case AdcMode::HZ_26:
+                return 33553;
+            default:
+                return 0;
+        }
+    }
+
+    static constexpr int32_t cells_conversion_time_us(AdcMode mode) {
+        return cell_channels * channel_time_us(mode);
+    }
+
+    static constexpr int32_t GPIOs_conversion_time_us(AdcMode mode) {
+        return GPIO_channels * channel_time_us(mode);
+    }
+
+    static constexpr int32_t conversion_time_us(AdcMode mode) {
+        return cells_conversion_time_us(mode) + GPIOs_conversion_time_us(mode);
+    }
+
+    static constexpr int32_t cycle_time_us(AdcMode mode) {
+        return wire_time_us(cycle_bytes) + conversion_time_us(mode);
+    }
+
+    // headroom_us is what is left of period_us in the current AdcMode
+    static constexpr BusReport report(const LinkStats& stats,
+                                      int32_t cycle_time, AdcMode mode,
+                                      int32_t period_us) {
+        BusReport bus_report{stats.transactions, stats.bytes,
+                             wire_time_us(stats.bytes), cycle_time,
+                             cycle_time_us(mode)};
+        bus_report.headroom_us = period_us - bus_report.expected_cycle_time_us;
+        if (cycle_time > 0) {
+            bus_report.utilization =
+                static_cast<float>(bus_report.bus_time_us) / cycle_time;
+            bus_report.idle = 1.0f - bus_report.utilization;
+        }
+        return bus_report;
+    }
+};
+}  // namespace LTC6810Driver
+
+#endif
@@ -23,6 +23,25 @@ enum class AdcMode : uint8_t {
     HZ_26 = 7
 };
 
+enum class DischargeTime : uint8_t {
+    DISABLED = 0x0,
+    MIN_0_5 = 0x1,
+    MIN_1 = 0x2,
+    MIN_2 = 0x3,
+    MIN_3 = 0x4,
+    MIN_4 = 0x5,
+    MIN_5 = 0x6,
+    MIN_10 = 0x7,
+    MIN_15 = 0x8,
+    MIN_20 = 0x9,
+    MIN_30 = 0xA,
+    MIN_40 = 0xB,
+    MIN_60 = 0xC,
+    MIN_75 = 0xD,
+    MIN_90 = 0xE,
+    MIN_120 = 0xF
+};
+
 template <size_t N_LTC6810>
 class Driver {
     constexpr uint16_t build_ADCV(AdcMode mode) {
@@ -48,23 +67,24 @@ class Driver {
         }
     }
 
+    // DCP = 0: the LTC6810 pauses cell discharge while converting
     constexpr uint16_t build_ADCVSC(AdcMode mode) {
         switch (mode) {
             case AdcMode::HZ_422:
             case AdcMode::KHZ_1:
-                return 0b0000010001110111;
+                return 0b0000010001100111;
 
             case AdcMode::KHZ_27:
             case AdcMode::KHZ_14:
-                return 0b0000010011110111;
+                return 0b0000010011100111;
 
             case AdcMode::KHZ_7:
             case AdcMode::KHZ_3:
-                return 0b0000010101110111;
+                return 0b0000010101100111;
 
             case AdcMode::HZ_26:
             case AdcMode::KHZ_2:
-                return 0b0000010111110111;
+                return 0b0000010111100111;
 
             default:
                 return 0;
@@ -94,14 +114,39 @@ class Driver {
         }
     }
 
-    static constexpr array<uint8_t, 6> build_CRG() {
+    // Modes sharing MD bits are told apart by ADCOPT
+    static constexpr bool build_ADCOPT(AdcMode mode) {
+        switch (mode) {
+            case AdcMode::KHZ_14:
+            case AdcMode::KHZ_3:
+            case AdcMode::KHZ_2:
+            case AdcMode::KHZ_1:
+                return true;
+
+            default:
+                return false;
+        }
+    }
+
+    static constexpr array<uint8_t, 6> build_CRG(
+        uint8_t discharge = 0, DischargeTime time = DischargeTime::DISABLED,
+        AdcMode mode = AdcMode::HZ_26) {
+        uint8_t CFGR0 = build_ADCOPT(mode);
+        uint8_t CFGR4 = (discharge & 0x3F) << 1;
+        uint8_t CFGR5 = static_cast<uint8_t>(time) << 4;
         if constexpr (REFON) {
-            return {0x7C, 0x00, 0x00, 0x00, 0x00, 0x00};
+            return {uint8_t(0x7C | CFGR0), 0x00, 0x00, 0x00, CFGR4, CFGR5};
         } else {
-            return {0x78, 0x00, 0x00, 0x00, 0x00, 0x00};
+            return {uint8_t(0x78 | CFGR0), 0x00, 0x00, 0x00, CFGR4, CFGR5};
         }
     }
 
+    static constexpr array<Register, N_LTC6810> build_CFG() {
+        array<Register, N_LTC6810> CFG;
+        CFG.fill(Register{build_CRG()});
+        return CFG;
+    }
+
     AdcMode current_mode{AdcMode::HZ_26};
 
     // Commands
@@ -116,7 +161,11 @@ class Driver {
     Command RDSTATA{0b0000000000010000};
 
     // Registers
-    Register CFG{build_CRG()};
+    array<Register, N_LTC6810> CFG{build_CFG()};
+
+    array<uint8_t, N_LTC6810> discharge{};
+    DischargeTime discharge_time{DischargeTime::DISABLED};
+    bool CFG_changed{false};
 
     LTC6810Driver::NetworkLink<N_LTC6810> link;
 
@@ -126,6 +175,26 @@ class Driver {
     void wake_up() {
         link.wake_up();
         link.write(WRCFG, CFG);
+        CFG_changed = false;
+    }
+
+    void set_discharge(const array<uint8_t, N_LTC6810>& new_discharge,
+                       DischargeTime time) {
+        for (uint i{0}; i < N_LTC6810; ++i) {
+            if (new_discharge[i] != discharge[i] || time != discharge_time) {
+                discharge[i] = new_discharge[i];
+                CFG[i] = Register{build_CRG(discharge[i], time, current_mode)};
+                CFG_changed = true;
+            }
+        }
+        discharge_time = time;
+    }
+
+    bool is_config_changed() const { return CFG_changed; }
+
+    void write_config() {
+        link.write(WRCFG, CFG);
+        CFG_changed = false;
     }
 
     void start_cell_conversion() { link.send(ADCVSC); }
@@ -184,6 +253,11 @@ class Driver {
         return GPIOs;
     }
 
+    AdcMode get_mode() const { return current_mode; }
+
+    const LinkStats& get_link_stats() const { return link.get_stats(); }
+    void reset_link_stats() { link.reset_stats(); }
+
     void faster_conv() {
         if (static_cast<int>(current_mode) > 0) {
             current_mode =
@@ -191,6 +265,16 @@ class Driver {
             ADCV = build_ADCV(current_mode);
             ADCVSC = build_ADCVSC(current_mode);
             ADAX = build_ADAX(current_mode);
+
+            if (build_ADCOPT(current_mode) !=
+                build_ADCOPT(static_cast<AdcMode>(
+                    static_cast<int>(current_mode) + 1))) {
+                for (uint i{0}; i < N_LTC6810; ++i) {
+                    CFG[i] = Register{
+                        build_CRG(discharge[i], discharge_time, current_mode)};
+                }
+                write_config();
+            }
         }
     }
 };
@@ -2,6 +2,7 @@
 #define LTC6810_HPP
 
 #include <array>
+#include <cstdint>
 
 constexpr size_t N_GPIOS{4};
 
@@ -15,6 +16,7 @@ class LTC6810 {
 
    public:
     std::array<float, N_CELLS> cells{};
+    std::array<int32_t, N_CELLS> cells_timestamp{};
     std::array<float, N_GPIOS> GPIOs{};
     float conv_rate{1.0};
     float total_voltage{};
@@ -20,36 +20,69 @@ struct SPIConfig {
     void (*const SPI_CS_turn_on)(void);
 };
 
+struct LinkStats {
+    uint32_t transactions{};
+    uint32_t bytes{};
+};
+
 template <size_t N_LTC6810>
 class NetworkLink {
     const SPIConfig spi_link;
 
     static inline Command PLADC{0b0000011100010100};
 
+    mutable LinkStats stats{};
+
+    void select() const {
+        spi_link.SPI_CS_turn_off();
+        ++stats.transactions;
+    }
+    void deselect() const { spi_link.SPI_CS_turn_on(); }
+    void transmit(const std::span<uint8_t> data) const {
+        spi_link.SPI_transmit(data);
+        stats.bytes += data.size();
+    }
+    void receive(std::span<uint8_t> data) const {
+        spi_link.SPI_receive(data);
+        stats.bytes += data.size();
+    }
+
    public:
+    // Bytes on the wire for each operation, one chip select frame each
+    // (wake_up uses N_LTC6810 frames of one byte)
+    static constexpr size_t command_bytes{sizeof(Command::command)};
+    static constexpr size_t register_bytes{sizeof(Register::reg)};
+    static constexpr size_t wake_up_bytes{N_LTC6810};
+    static constexpr size_t poll_bytes{command_bytes + (N_LTC6810 / 8) + 2};
+    static constexpr size_t read_bytes{command_bytes +
+                                       N_LTC6810 * register_bytes};
+    static constexpr size_t write_bytes{command_bytes +
+                                        N_LTC6810 * register_bytes};
+    static constexpr size_t send_bytes{command_bytes};
+
     consteval NetworkLink(const SPIConfig& config) : spi_link{config} {}
 
     void wake_up() const {
         array<uint8_t, 1> byte{0XFF};
         for (uint i{0}; i < N_LTC6810; ++i) {
-            spi_link.SPI_CS_turn_off();
-            spi_link.SPI_transmit(byte);
-            spi_link.SPI_CS_turn_on();
+            select();
+            transmit(byte);
+            deselect();
         }
     }
 
     bool is_conv_done() const {
         std::array<uint8_t, 1> data;
 
-        spi_link.SPI_CS_turn_off();
-        spi_link.SPI_transmit(PLADC.command);
+        select();
+        transmit(PLADC.command);
 
         for (uint i{0}; i < (N_LTC6810 / 8) + 1; ++i) {
-            spi_link.SPI_receive(data);
+            receive(data);
         }
-        spi_link.SPI_receive(data);
+        receive(data);
 
-        spi_link.SPI_CS_turn_on();
+        deselect();
 
         return data[0] > 0;
     }
@@ -57,32 +90,41 @@ class NetworkLink {
     array<Register, N_LTC6810> read(Command command) const {
         array<Register, N_LTC6810> registers;
 
-        spi_link.SPI_CS_turn_off();
-        spi_link.SPI_transmit(command.command);
+        select();
+        transmit(command.command);
 
         array<uint8_t, 8> reg;
         for (uint i{0}; i < N_LTC6810; ++i) {
-            spi_link.SPI_receive(reg);
+            receive(reg);
             registers[i] = Register(std::move(reg));
         }
 
-        spi_link.SPI_CS_turn_on();
+        deselect();
 
         return registers;
     }
 
-    void write(Command command, Register reg) const {
-        spi_link.SPI_CS_turn_off();
-        spi_link.SPI_transmit(command.command);
-        spi_link.SPI_transmit(reg.reg);
-        spi_link.SPI_CS_turn_on();
+    // The first register shifted in ends up in the last LTC6810 of the chain
+    void write(Command command, const array<Register, N_LTC6810>& regs) const {
+        select();
+        transmit(command.command);
+
+        array<uint8_t, 8> reg;
+        for (auto it{regs.rbegin()}; it != regs.rend(); ++it) {
+            reg = it->reg;
+            transmit(reg);
+        }
+        deselect();
     }
 
     void send(Command command) const {
-        spi_link.SPI_CS_turn_off();
-        spi_link.SPI_transmit(command.command);
-        spi_link.SPI_CS_turn_on();
+        select();
+        transmit(command.command);
+        deselect();
     }
+
+    const LinkStats& get_stats() const { return stats; }
+    void reset_stats() { stats = {}; }
 };
 }  // namespace LTC6810Driver
 #endif
\ No newline at end of file
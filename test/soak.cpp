@@ -0,0 +1,709 @@
+// Host soak harness: runs BMS::update() against a simulated LTC6810 chain
+// behind a fake SPI bus that injects bit errors, dropped bytes, stuck
+// conversions and devices missing from the chain.
+//
+// Usage: soak [scenario=faults|balancing] [updates=N] [step_us=N] [seed=N]
+//             [bit_error=P] [drop=P]
+//             [stuck=P] [burst_interval_ms=N] [burst_length_ms=N]
+//             [burst_missing=N] [max_timeouts=N] [max_stale_ms=N]
+//             [max_recovery_ms=N]
+//
+// scenario=balancing runs a fault-free script instead, checking the DCC and
+// DCTO bits each LTC6810 receives through WRCFG and when WRCFG is sent.
+// burst_interval_ms=0 disables the bursts. The max_* limits make the run fail
+// when exceeded. Simulated time runs past the wrap of the driver's int32_t
+// microsecond clock, every age below is computed as a wrapped difference.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "BMS.hpp"
+#include "BusTiming.hpp"
+
+namespace {
+
+constexpr size_t N_DEVICES{8};
+constexpr uint32_t SPI_CLOCK_HZ{1000000};
+constexpr int64_t BYTE_TIME_NS{8000000000LL / SPI_CLOCK_HZ};
+constexpr int64_t AGE_SAMPLE_US{1000};
+
+// Simulated time as the driver sees it, an int32_t microsecond clock
+int32_t tick_us(int64_t ns) {
+    return static_cast<int32_t>(static_cast<uint32_t>(ns / 1000));
+}
+
+int32_t elapsed_us(int32_t now, int32_t then) {
+    return static_cast<int32_t>(static_cast<uint32_t>(now) -
+                                static_cast<uint32_t>(then));
+}
+
+using Timing = LTC6810Driver::BusTiming<N_DEVICES, SPI_CLOCK_HZ>;
+
+enum class Burst { BIT_ERRORS, DROPS, STUCK, MISSING, N_BURSTS };
+constexpr std::array<const char*, 4> BURST_NAMES{"bit errors", "dropped bytes",
+                                                 "stuck conversion",
+                                                 "missing devices"};
+
+struct Options {
+    std::string scenario{"faults"};
+    uint64_t updates{10000000};
+    int64_t step_us{20};
+    uint64_t seed{1};
+    // Background rates, per byte (bit_error, drop) and per conversion (stuck)
+    double bit_error{1e-6};
+    double drop{1e-6};
+    double stuck{1e-4};
+    // Periodic fault bursts, rotating through every Burst kind
+    int64_t burst_interval_us{2000000};
+    int64_t burst_length_us{200000};
+    double burst_bit_error{1e-2};
+    double burst_drop{1e-2};
+    size_t burst_missing{2};
+    // Pass limits, negative means unchecked
+    int64_t max_timeouts{-1};
+    int64_t max_stale_ms{-1};
+    int64_t max_recovery_ms{-1};
+};
+
+class FakeChain {
+    enum class Frame { NONE, IGNORED, WAKE, POLL, READ, WRITE, SEND };
+
+    std::mt19937_64 rng;
+    std::uniform_real_distribution<double> uniform{0.0, 1.0};
+
+    Frame frame{Frame::NONE};
+    uint16_t frame_command{};
+    std::vector<uint8_t> response;
+    size_t cursor{};
+
+    bool stuck{false};
+    bool adcopt{false};
+    bool converting{false};
+    int64_t conv_done_ns{};
+
+    array<array<float, 6>, N_DEVICES> cells;
+    array<array<LTC6810Driver::Register, 5>, N_DEVICES> registers;
+    size_t write_index{};
+
+    bool chance(double p) { return p > 0.0 && uniform(rng) < p; }
+
+    uint8_t corrupt(uint8_t byte) {
+        if (chance(bit_error)) {
+            byte ^= 1 << (rng() % 8);
+        }
+        return byte;
+    }
+
+    static LTC6810Driver::Register make_register(float v0, float v1, float v2,
+                                                 float lsb) {
+        array<uint8_t, 6> data;
+        uint i{};
+        for (float v : {v0, v1, v2}) {
+            uint16_t code = static_cast<uint16_t>(v / lsb);
+            data[i++] = code;
+            data[i++] = code >> 8;
+        }
+        return LTC6810Driver::Register{std::move(data)};
+    }
+
+    // MD bits, with the ADCOPT last written by WRCFG
+    LTC6810Driver::AdcMode decode_mode(uint16_t command) const {
+        using LTC6810Driver::AdcMode;
+        constexpr array<AdcMode, 4> modes{AdcMode::HZ_422, AdcMode::KHZ_27,
+                                          AdcMode::KHZ_7, AdcMode::HZ_26};
+        constexpr array<AdcMode, 4> opt_modes{AdcMode::KHZ_1, AdcMode::KHZ_14,
+                                              AdcMode::KHZ_3, AdcMode::KHZ_2};
+        return (adcopt ? opt_modes : modes)[(command >> 7) & 0b11];
+    }
+
+    void start_conversion(uint16_t command, size_t channels) {
+        if (chance(stuck_rate)) {
+            stuck = true;
+        }
+        converting = true;
+        conv_done_ns =
+            now_ns + 1000LL * channels *
+                         Timing::channel_time_us(decode_mode(command));
+    }
+
+    void load_read(size_t reg) {
+        response.clear();
+        for (size_t i{0}; i < N_DEVICES; ++i) {
+            if (i < present) {
+                auto& data = registers[i][reg].reg;
+                response.insert(response.end(), data.begin(), data.end());
+            } else {
+                response.insert(response.end(), 8, 0xFF);
+            }
+        }
+    }
+
+    void decode_command(std::span<uint8_t> bytes) {
+        array<uint8_t, 2> code{bytes[0], bytes[1]};
+        uint16_t pec{LTC6810Driver::calculate_pec(code)};
+        if (bytes[2] != static_cast<uint8_t>(pec >> 8) ||
+            bytes[3] != static_cast<uint8_t>(pec)) {
+            frame = Frame::IGNORED;
+            return;
+        }
+
+        frame_command = (code[0] << 8) | code[1];
+        uint16_t base = frame_command & ~0x0180;
+        if (base == 0x0467) {  // ADCVSC
+            frame = Frame::SEND;
+            start_conversion(frame_command, Timing::cell_channels);
+            ++cells_conversions;
+            // A cycle retried after a timeout keeps its first start
+            attempt_start_ns = now_ns;
+            if (!cycle_open) {
+                cycle_start_ns = now_ns;
+                cycle_open = true;
+            }
+        } else if (base == 0x0460) {  // ADAX
+            frame = Frame::SEND;
+            start_conversion(frame_command, Timing::GPIO_channels);
+        } else if (frame_command == 0x0714) {  // PLADC
+            frame = Frame::POLL;
+            bool done = converting && !stuck && now_ns >= conv_done_ns;
+            response.assign((N_DEVICES / 8) + 2, done ? 0xFF : 0x00);
+        } else if (frame_command == 0x0001) {  // WRCFG
+            frame = Frame::WRITE;
+            write_index = 0;
+            ++config_writes;
+        } else if (frame_command == 0x0004) {  // RDCVA
+            frame = Frame::READ;
+            load_read(0);
+        } else if (frame_command == 0x0006) {  // RDCVB
+            frame = Frame::READ;
+            load_read(1);
+        } else if (frame_command == 0x0010) {  // RDSTATA
+            frame = Frame::READ;
+            load_read(2);
+        } else if (frame_command == 0x000C) {  // RDAUXA
+            frame = Frame::READ;
+            load_read(3);
+        } else if (frame_command == 0x000E) {  // RDAUXB
+            frame = Frame::READ;
+            load_read(4);
+        } else {
+            frame = Frame::IGNORED;
+        }
+    }
+
+   public:
+    int64_t now_ns{};
+
+    double bit_error{};
+    double drop{};
+    double stuck_rate{};
+    size_t present{N_DEVICES};
+
+    // Events observed on the bus, consumed by the harness after each update
+    uint64_t cells_conversions{};
+    int64_t cycle_start_ns{};
+    int64_t attempt_start_ns{};
+    bool cycle_open{false};
+    bool cells_read{false};
+    bool cycle_read{false};
+
+    // Configuration last written to each LTC6810 and WRCFG frames seen
+    array<array<uint8_t, 6>, N_DEVICES> cfg{};
+    uint64_t config_writes{};
+
+    explicit FakeChain(uint64_t seed) : rng(seed) {
+        std::normal_distribution<float> spread{0.0f, 0.004f};
+        for (size_t i{0}; i < N_DEVICES; ++i) {
+            for (size_t j{0}; j < cells[i].size(); ++j) {
+                set_cell(i, j, 3.6f + spread(rng));
+            }
+            registers[i][3] =
+                make_register(1.0f, 1.1f, 1.2f, ADC_RESOLUTION);
+            registers[i][4] =
+                make_register(1.3f, 1.4f, 3.0f, ADC_RESOLUTION);
+        }
+    }
+
+    void set_cell(size_t device, size_t cell, float voltage) {
+        auto& v = cells[device];
+        v[cell] = voltage;
+        registers[device][0] = make_register(v[0], v[1], v[2], ADC_RESOLUTION);
+        registers[device][1] = make_register(v[3], v[4], v[5], ADC_RESOLUTION);
+        float sum{};
+        for (float c : v) {
+            sum += c;
+        }
+        registers[device][2] =
+            make_register(sum, 2.0f, 5.0f, ADC_RESOLUTION * 10);
+    }
+
+    uint8_t discharge(size_t device) const {
+        return (cfg[device][4] >> 1) & 0x3F;
+    }
+    uint8_t discharge_time(size_t device) const { return cfg[device][5] >> 4; }
+
+    void select() {
+        frame = Frame::NONE;
+        response.clear();
+        cursor = 0;
+    }
+
+    void deselect() {
+        if (frame == Frame::READ && frame_command == 0x0010) {
+            cells_read = true;
+        } else if (frame == Frame::READ && frame_command == 0x000E) {
+            cycle_read = true;
+            cycle_open = false;
+        }
+        frame = Frame::NONE;
+    }
+
+    void transmit(std::span<uint8_t> data) {
+        now_ns += data.size() * BYTE_TIME_NS;
+        if (frame == Frame::WRITE && data.size() == 8) {
+            LTC6810Driver::Register reg;
+            std::copy(data.begin(), data.end(), reg.reg.begin());
+            // The first register shifted in belongs to the last LTC6810
+            if (reg.is_pec_valid() && write_index < N_DEVICES) {
+                auto& device_cfg = cfg[N_DEVICES - 1 - write_index];
+                std::copy(data.begin(), data.begin() + 6, device_cfg.begin());
+                adcopt = reg.reg[0] & 1;
+            }
+            ++write_index;
+            return;
+        }
+        if (frame != Frame::NONE) {
+            return;
+        }
+        if (data.size() == 1) {
+            // Wake-up frame, a hung conversion is cleared by waking the chain
+            frame = Frame::WAKE;
+            stuck = false;
+            return;
+        }
+        array<uint8_t, 4> bytes;
+        for (size_t i{0}; i < bytes.size(); ++i) {
+            bytes[i] = corrupt(data[i]);
+        }
+        decode_command(bytes);
+    }
+
+    void receive(std::span<uint8_t> data) {
+        now_ns += data.size() * BYTE_TIME_NS;
+        for (auto& byte : data) {
+            if (cursor < response.size() && chance(drop)) {
+                ++cursor;
+            }
+            byte = corrupt(cursor < response.size() ? response[cursor++]
+                                                    : 0xFF);
+        }
+    }
+};
+
+FakeChain* chain{nullptr};
+
+struct Cfg {
+    static constexpr uint32_t n_LTC6810{N_DEVICES};
+    static void SPI_transmit(std::span<uint8_t> data) {
+        chain->transmit(data);
+    }
+    static void SPI_receive(std::span<uint8_t> data) { chain->receive(data); }
+    static void SPI_CS_turn_off() { chain->select(); }
+    static void SPI_CS_turn_on() { chain->deselect(); }
+    static int32_t get_tick() { return tick_us(chain->now_ns); }
+    static constexpr int32_t tick_resolution_us{1};
+    static constexpr int32_t period_us{10000};
+    static constexpr int32_t conv_rate_time_ms{1000};
+    static constexpr uint32_t SPI_clock_hz{SPI_CLOCK_HZ};
+};
+
+using SoakBMS = BMS<Cfg>;
+
+struct Recovery {
+    std::vector<int64_t> times_us;
+    uint32_t unrecovered{};
+};
+
+int64_t percentile(std::vector<int64_t>& values, double p) {
+    if (values.empty()) {
+        return 0;
+    }
+    size_t index = static_cast<size_t>(p * (values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+void print_percentiles(const char* name, std::vector<int64_t> values) {
+    if (values.empty()) {
+        std::printf("  %-18s no samples\n", name);
+        return;
+    }
+    std::printf(
+        "  %-18s n=%zu p50=%.2f p90=%.2f p99=%.2f p99.9=%.2f max=%.2f ms\n",
+        name, values.size(), percentile(values, 0.5) / 1000.0,
+        percentile(values, 0.9) / 1000.0, percentile(values, 0.99) / 1000.0,
+        percentile(values, 0.999) / 1000.0,
+        *std::max_element(values.begin(), values.end()) / 1000.0);
+}
+
+bool parse(Options& options, const std::string& arg) {
+    auto eq = arg.find('=');
+    if (eq == std::string::npos) {
+        return false;
+    }
+    std::string key{arg.substr(0, eq)};
+    const char* value{arg.c_str() + eq + 1};
+    if (key == "scenario") {
+        options.scenario = value;
+        return options.scenario == "faults" || options.scenario == "balancing";
+    } else if (key == "updates") {
+        options.updates = std::strtoull(value, nullptr, 10);
+    } else if (key == "step_us") {
+        options.step_us = std::max(1LL, std::strtoll(value, nullptr, 10));
+    } else if (key == "seed") {
+        options.seed = std::strtoull(value, nullptr, 10);
+    } else if (key == "bit_error") {
+        options.bit_error = std::strtod(value, nullptr);
+    } else if (key == "drop") {
+        options.drop = std::strtod(value, nullptr);
+    } else if (key == "stuck") {
+        options.stuck = std::strtod(value, nullptr);
+    } else if (key == "burst_interval_ms") {
+        options.burst_interval_us = std::strtoll(value, nullptr, 10) * 1000;
+    } else if (key == "burst_length_ms") {
+        options.burst_length_us = std::strtoll(value, nullptr, 10) * 1000;
+    } else if (key == "burst_missing") {
+        options.burst_missing = std::strtoull(value, nullptr, 10);
+    } else if (key == "max_timeouts") {
+        options.max_timeouts = std::strtoll(value, nullptr, 10);
+    } else if (key == "max_stale_ms") {
+        options.max_stale_ms = std::strtoll(value, nullptr, 10);
+    } else if (key == "max_recovery_ms") {
+        options.max_recovery_ms = std::strtoll(value, nullptr, 10);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void run_for(FakeChain& fake, int64_t time_us, int64_t step_us) {
+    int64_t end_ns{fake.now_ns + time_us * 1000};
+    while (fake.now_ns < end_ns) {
+        fake.now_ns += step_us * 1000;
+        SoakBMS::update();
+    }
+}
+
+int run_balancing(FakeChain& fake, const Options& options) {
+    constexpr float BASE_V{3.6f};
+    constexpr int64_t SETTLE_US{50000};
+    constexpr auto DCTO{static_cast<uint8_t>(BALANCING_TIME)};
+
+    bool failed{false};
+    auto expect = [&](bool ok, const char* what) {
+        std::printf("  %-58s %s\n", what, ok ? "ok" : "FAIL");
+        failed |= !ok;
+    };
+    // Every device but the listed ones must have no DCC bit set
+    auto expect_masks = [&](array<uint8_t, N_DEVICES> masks, uint8_t dcto,
+                            const char* what) {
+        bool ok{true};
+        for (size_t i{0}; i < N_DEVICES; ++i) {
+            ok &= fake.discharge(i) == masks[i];
+            ok &= fake.discharge_time(i) == dcto;
+        }
+        expect(ok, what);
+    };
+    auto step = [&](int64_t time_us) {
+        uint64_t writes{fake.config_writes};
+        run_for(fake, time_us, options.step_us);
+        return fake.config_writes - writes;
+    };
+
+    // Seeded spread well below the release threshold
+    std::mt19937_64 rng{options.seed};
+    std::uniform_real_distribution<float> spread{0.0f, 0.002f};
+    for (size_t i{0}; i < N_DEVICES; ++i) {
+        for (size_t j{0}; j < N_CELLS; ++j) {
+            fake.set_cell(i, j, BASE_V + spread(rng));
+        }
+    }
+
+    std::printf("balancing scenario, seed %llu\n",
+                static_cast<unsigned long long>(options.seed));
+    step(1000000);
+    expect_masks({}, 0, "no discharge before start_balancing()");
+
+    fake.set_cell(1, 2, BASE_V + 0.015f);
+    fake.set_cell(6, 5, BASE_V + 0.012f);
+    SoakBMS::start_balancing();
+    expect(step(SETTLE_US) == 1, "one WRCFG when balancing starts");
+    expect_masks({0, 1 << 2, 0, 0, 0, 0, 1 << 5, 0}, DCTO,
+                 "LTC6810 1 cell 2 and LTC6810 6 cell 5 discharge");
+
+    expect(step(5000000) == 0, "no WRCFG while the masks don't change");
+    expect(step(5000000) == 1, "one WRCFG refresh every 10 s");
+    expect_masks({0, 1 << 2, 0, 0, 0, 0, 1 << 5, 0}, DCTO,
+                 "refresh keeps the same masks");
+
+    fake.set_cell(1, 2, BASE_V + 0.007f);
+    expect(step(SETTLE_US) == 0, "between release and trigger: no WRCFG");
+    expect_masks({0, 1 << 2, 0, 0, 0, 0, 1 << 5, 0}, DCTO,
+                 "between release and trigger: still discharging");
+
+    fake.set_cell(1, 2, BASE_V + 0.003f);
+    expect(step(SETTLE_US) == 1, "below release: one WRCFG");
+    expect_masks({0, 0, 0, 0, 0, 0, 1 << 5, 0}, DCTO,
+                 "below release: LTC6810 1 cell 2 released");
+
+    fake.set_cell(1, 2, BASE_V + 0.007f);
+    expect(step(SETTLE_US) == 0, "back between release and trigger: no WRCFG");
+    expect_masks({0, 0, 0, 0, 0, 0, 1 << 5, 0}, DCTO,
+                 "back between release and trigger: not discharging");
+
+    fake.set_cell(1, 2, BASE_V + 0.011f);
+    expect(step(SETTLE_US) == 1, "above trigger: one WRCFG");
+    expect_masks({0, 1 << 2, 0, 0, 0, 0, 1 << 5, 0}, DCTO,
+                 "above trigger: LTC6810 1 cell 2 discharges again");
+
+    SoakBMS::stop_balancing();
+    expect(step(SETTLE_US) == 1, "one WRCFG when balancing stops");
+    expect_masks({}, 0, "no discharge after stop_balancing()");
+
+    std::printf("%s\n", failed ? "balancing FAILED" : "balancing passed");
+    return failed ? 1 : 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    for (int i{1}; i < argc; ++i) {
+        if (!parse(options, argv[i])) {
+            std::fprintf(stderr, "unknown option: %s\n", argv[i]);
+            return 2;
+        }
+    }
+    options.burst_missing = std::min(options.burst_missing, N_DEVICES);
+
+    FakeChain fake{options.seed};
+    chain = &fake;
+
+    if (options.scenario == "balancing") {
+        fake.bit_error = 0.0;
+        fake.drop = 0.0;
+        fake.stuck_rate = 0.0;
+        return run_balancing(fake, options);
+    }
+
+    std::vector<int64_t> latencies;
+    std::vector<int64_t> attempt_latencies;
+    array<array<int64_t, N_CELLS>, N_DEVICES> max_age{};
+    array<array<int64_t, N_CELLS>, N_DEVICES> sum_age{};
+    uint64_t age_samples{};
+    int64_t next_age_sample_us{};
+    array<Recovery, BURST_NAMES.size()> recoveries;
+    float min_conv_rate{1.0f};
+    uint64_t cycles{};
+    int64_t last_cycle_ns{};
+    int64_t max_cycle_gap_ns{};
+
+    bool in_burst{false};
+    Burst burst{};
+    uint64_t n_bursts{};
+    bool recovering{false};
+    int32_t burst_end_tick{};
+    int64_t burst_end_us{};
+    Burst recovering_burst{};
+
+    auto wall_start = std::chrono::steady_clock::now();
+    uint64_t update{0};
+    for (; update < options.updates; ++update) {
+        fake.now_ns += options.step_us * 1000;
+        int64_t now_us{fake.now_ns / 1000};
+
+        // Fault bursts start at the end of each interval
+        bool burst_now{false};
+        if (options.burst_interval_us > 0) {
+            int64_t phase{now_us % options.burst_interval_us};
+            burst_now = now_us >= options.burst_interval_us &&
+                        phase < options.burst_length_us;
+        }
+        if (burst_now && !in_burst) {
+            if (recovering) {
+                ++recoveries[static_cast<size_t>(recovering_burst)]
+                      .unrecovered;
+                recovering = false;
+            }
+            burst = static_cast<Burst>(n_bursts++ %
+                                       static_cast<size_t>(Burst::N_BURSTS));
+        } else if (!burst_now && in_burst) {
+            recovering = true;
+            recovering_burst = burst;
+            burst_end_us = now_us;
+            burst_end_tick = tick_us(fake.now_ns);
+        }
+        in_burst = burst_now;
+
+        fake.bit_error = (in_burst && burst == Burst::BIT_ERRORS)
+                             ? options.burst_bit_error
+                             : options.bit_error;
+        fake.drop = (in_burst && burst == Burst::DROPS) ? options.burst_drop
+                                                        : options.drop;
+        fake.stuck_rate =
+            (in_burst && burst == Burst::STUCK) ? 1.0 : options.stuck;
+        fake.present = (in_burst && burst == Burst::MISSING)
+                           ? N_DEVICES - options.burst_missing
+                           : N_DEVICES;
+
+        SoakBMS::update();
+
+        auto& ltcs = SoakBMS::get_data();
+        now_us = fake.now_ns / 1000;
+        int32_t now_tick{tick_us(fake.now_ns)};
+        if (fake.cycle_read) {
+            fake.cycle_read = false;
+            ++cycles;
+            latencies.push_back((fake.now_ns - fake.cycle_start_ns) / 1000);
+            attempt_latencies.push_back(
+                (fake.now_ns - fake.attempt_start_ns) / 1000);
+            if (last_cycle_ns > 0) {
+                max_cycle_gap_ns =
+                    std::max(max_cycle_gap_ns, fake.now_ns - last_cycle_ns);
+            }
+            last_cycle_ns = fake.now_ns;
+        }
+        // Ages are sampled on a fixed grid once the first cycle is read, so
+        // data left stale by a stuck or failing chain shows up
+        if (cycles > 0 && now_us >= next_age_sample_us) {
+            next_age_sample_us = now_us - (now_us % AGE_SAMPLE_US) +
+                                 AGE_SAMPLE_US;
+            ++age_samples;
+            for (size_t i{0}; i < N_DEVICES; ++i) {
+                for (size_t j{0}; j < N_CELLS; ++j) {
+                    int64_t age{
+                        elapsed_us(now_tick, ltcs[i].cells_timestamp[j])};
+                    max_age[i][j] = std::max(max_age[i][j], age);
+                    sum_age[i][j] += age;
+                }
+                min_conv_rate = std::min(min_conv_rate, ltcs[i].conv_rate);
+            }
+        }
+        if (recovering) {
+            bool fresh{true};
+            for (size_t i{0}; i < N_DEVICES && fresh; ++i) {
+                for (size_t j{0}; j < N_CELLS && fresh; ++j) {
+                    fresh = elapsed_us(ltcs[i].cells_timestamp[j],
+                                       burst_end_tick) >= 0;
+                }
+            }
+            if (fresh) {
+                recoveries[static_cast<size_t>(recovering_burst)]
+                    .times_us.push_back(now_us - burst_end_us);
+                recovering = false;
+            }
+        }
+    }
+    if (recovering) {
+        ++recoveries[static_cast<size_t>(recovering_burst)].unrecovered;
+    }
+    double wall_s{std::chrono::duration<double>(
+                      std::chrono::steady_clock::now() - wall_start)
+                      .count()};
+    double sim_s{fake.now_ns / 1e9};
+
+    std::printf("LTC6810 soak: %zu devices, SPI %u Hz, period %d us, seed %llu\n",
+                N_DEVICES, SPI_CLOCK_HZ, Cfg::period_us,
+                static_cast<unsigned long long>(options.seed));
+    std::printf("faults: bit_error=%g drop=%g stuck=%g, %llu bursts of %lld ms\n",
+                options.bit_error, options.drop, options.stuck,
+                static_cast<unsigned long long>(n_bursts),
+                static_cast<long long>(options.burst_length_us / 1000));
+
+    std::printf("\nthroughput\n");
+    std::printf("  updates            %llu in %.2f s wall (%.0f updates/s)\n",
+                static_cast<unsigned long long>(update), wall_s,
+                update / wall_s);
+    std::printf("  simulated time     %.2f s\n", sim_s);
+    std::printf("  cycles             %llu (%.1f cycles/s simulated)\n",
+                static_cast<unsigned long long>(cycles), cycles / sim_s);
+    std::printf("  cell conversions   %llu started\n",
+                static_cast<unsigned long long>(fake.cells_conversions));
+    std::printf("  conv timeouts      %u\n", SoakBMS::get_conv_timeouts());
+    std::printf("  max cycle gap      %.2f ms\n", max_cycle_gap_ns / 1e6);
+    std::printf("  min conv_rate      %.3f\n", min_conv_rate);
+
+    std::printf("\nlatency (ADCVSC to RDAUXB)\n");
+    print_percentiles("cycle w/ retries", latencies);
+    print_percentiles("last attempt", attempt_latencies);
+
+    std::printf("\nrecovery (burst end to every cell fresh)\n");
+    uint32_t unrecovered{};
+    int64_t max_recovery_us{};
+    for (size_t k{0}; k < recoveries.size(); ++k) {
+        print_percentiles(BURST_NAMES[k], recoveries[k].times_us);
+        for (auto time : recoveries[k].times_us) {
+            max_recovery_us = std::max(max_recovery_us, time);
+        }
+        if (recoveries[k].unrecovered) {
+            std::printf("  %-18s %u bursts never recovered\n", BURST_NAMES[k],
+                        recoveries[k].unrecovered);
+        }
+        unrecovered += recoveries[k].unrecovered;
+    }
+
+    std::printf("\nstale-data age per cell every %lld ms, mean/max ms\n",
+                static_cast<long long>(AGE_SAMPLE_US / 1000));
+    int64_t max_stale_us{};
+    for (size_t i{0}; i < N_DEVICES; ++i) {
+        std::printf("  LTC6810 %zu:", i);
+        for (size_t j{0}; j < N_CELLS; ++j) {
+            std::printf(" %6.2f/%-7.2f",
+                        age_samples ? sum_age[i][j] / 1000.0 / age_samples
+                                    : 0.0,
+                        max_age[i][j] / 1000.0);
+            max_stale_us = std::max(max_stale_us, max_age[i][j]);
+        }
+        std::printf("\n");
+    }
+
+    auto& report = SoakBMS::get_bus_report();
+    std::printf("\nlast bus report\n");
+    std::printf(
+        "  %u transactions, %u bytes, bus %d us of %d us (%.1f%% busy), "
+        "expected %d us, headroom %d us\n",
+        report.transactions, report.bytes, report.bus_time_us,
+        report.cycle_time_us, report.utilization * 100,
+        report.expected_cycle_time_us, report.headroom_us);
+
+    bool failed{false};
+    auto check = [&](bool ok, const char* what) {
+        if (!ok) {
+            std::printf("FAIL: %s\n", what);
+            failed = true;
+        }
+    };
+    std::printf("\n");
+    check(cycles > 0, "no measurement cycle completed");
+    check(unrecovered == 0, "a fault burst never recovered");
+    check(options.max_timeouts < 0 ||
+              SoakBMS::get_conv_timeouts() <=
+                  static_cast<uint64_t>(options.max_timeouts),
+          "conversion timeouts above max_timeouts");
+    check(options.max_stale_ms < 0 ||
+              max_stale_us <= options.max_stale_ms * 1000,
+          "stale-data age above max_stale_ms");
+    check(options.max_recovery_ms < 0 ||
+              max_recovery_us <= options.max_recovery_ms * 1000,
+          "recovery time above max_recovery_ms");
+    std::printf("%s\n", failed ? "soak FAILED" : "soak passed");
+
+    return failed ? 1 : 0;
+}